@@ -0,0 +1,190 @@
+#include "casino_api.h"
+
+#include "casino_core.h"
+#include "casino_snapshot.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+// casino_table is never defined: handles are Session pointers, so tables
+// owned by a store and standalone ones look the same to callers.
+struct casino_sessions {
+    SessionStore store;
+};
+
+namespace {
+
+Session* session_of(casino_table* table) { return reinterpret_cast<Session*>(table); }
+const Session* session_of(const casino_table* table) { return reinterpret_cast<const Session*>(table); }
+casino_table* handle_of(Session* session) { return reinterpret_cast<casino_table*>(session); }
+
+bool can_play(const casino_table* table, const int32_t* balance, int32_t bet) {
+    return table && balance && bet > 0 && *balance >= bet;
+}
+
+// Batches settle against the session's own player, so a snapshot always
+// holds the wallet that goes with the engine and deck state.
+Player& start_batch(Session& session, int32_t balance, int32_t bet) {
+    session.player.balance = balance;
+    session.player.bet = bet;
+    session.dirty = true;
+    return session.player;
+}
+
+// Whether a round that can win up to max_gain keeps the balance in int32_t.
+bool round_fits(const Player& player, std::int64_t max_gain) {
+    return player.balance + max_gain <= std::numeric_limits<std::int32_t>::max();
+}
+
+}
+
+extern "C" {
+
+uint32_t casino_api_version(void) { return CASINO_API_VERSION; }
+
+casino_table* casino_table_create(uint32_t seed) {
+    try {
+        return handle_of(new Session(seed));
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void casino_table_destroy(casino_table* table) { delete session_of(table); }
+
+void casino_table_get_player(const casino_table* table, int32_t* balance, int32_t* bet) {
+    if (!table) return;
+    if (balance) *balance = session_of(table)->player.balance;
+    if (bet) *bet = session_of(table)->player.bet;
+}
+
+void casino_table_set_player(casino_table* table, int32_t balance, int32_t bet) {
+    if (!table) return;
+    Session* session = session_of(table);
+    session->player.balance = balance;
+    session->player.bet = bet;
+    session->dirty = true;
+}
+
+size_t casino_slots_spin_batch(casino_table* table, int32_t* balance, int32_t bet, size_t n,
+                               uint8_t* symbols_out, int32_t* multipliers_out) {
+    if (!can_play(table, balance, bet)) return 0;
+    Session* session = session_of(table);
+    Player& player = start_batch(*session, *balance, bet);
+    const std::int64_t max_gain = std::int64_t{bet} * (SLOTS_MAX_MULTIPLIER - 1);
+    SlotsReels reels;
+    size_t played = 0;
+    while (played < n && player.balance >= bet && round_fits(player, max_gain)) {
+        spin_slots(session->table.slots_rng, reels);
+        int multiplier = evaluate_slots(reels);
+        settle_spin(player, multiplier);
+        if (symbols_out) {
+            for (int i = 0; i < SLOTS_REELS; ++i) *symbols_out++ = static_cast<uint8_t>(reels[i]);
+        }
+        if (multipliers_out) multipliers_out[played] = multiplier;
+        ++played;
+    }
+    *balance = player.balance;
+    return played;
+}
+
+size_t casino_slots3x3_spin_batch(casino_table* table, int32_t* balance, int32_t bet, size_t n,
+                                  uint8_t* symbols_out, int32_t* multipliers_out, uint8_t* lines_out) {
+    if (!can_play(table, balance, bet)) return 0;
+    Session* session = session_of(table);
+    Player& player = start_batch(*session, *balance, bet);
+    const std::int64_t max_gain = std::int64_t{bet} * (SLOTS3X3_MAX_MULTIPLIER - 1);
+    Slots3x3Grid grid;
+    size_t played = 0;
+    while (played < n && player.balance >= bet && round_fits(player, max_gain)) {
+        spin_slots3x3(session->table.slots3x3_rng, grid);
+        unsigned lines = 0;
+        int multiplier = evaluate_slots3x3(grid, &lines);
+        settle_spin(player, multiplier);
+        if (symbols_out) {
+            for (const auto& row : grid) {
+                for (int symbol : row) *symbols_out++ = static_cast<uint8_t>(symbol);
+            }
+        }
+        if (multipliers_out) multipliers_out[played] = multiplier;
+        if (lines_out) lines_out[played] = static_cast<uint8_t>(lines);
+        ++played;
+    }
+    *balance = player.balance;
+    return played;
+}
+
+size_t casino_blackjack_play_batch(casino_table* table, int32_t* balance, int32_t bet, int32_t stand_on,
+                                   size_t n, uint8_t* results_out) {
+    if (!can_play(table, balance, bet)) return 0;
+    Session* session = session_of(table);
+    Table& t = session->table;
+    Player& player = start_batch(*session, *balance, bet);
+    const std::int64_t max_gain = Player::blackjack_win(bet);
+    size_t played = 0;
+    while (played < n && player.balance >= bet && round_fits(player, max_gain)) {
+        BlackjackResult result = play_blackjack_round(t.deck, t.player_hand, t.dealer_hand, stand_on);
+        settle_blackjack(player, result);
+        if (results_out) results_out[played] = static_cast<uint8_t>(result);
+        ++played;
+    }
+    *balance = player.balance;
+    return played;
+}
+
+casino_sessions* casino_sessions_create(void) {
+    return new (std::nothrow) casino_sessions();
+}
+
+void casino_sessions_destroy(casino_sessions* store) { delete store; }
+
+casino_table* casino_sessions_open(casino_sessions* store, uint32_t id, uint32_t seed) {
+    if (!store) return nullptr;
+    try {
+        return handle_of(&store->store.open(id, seed));
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+casino_table* casino_sessions_get(casino_sessions* store, uint32_t id) {
+    return store ? handle_of(store->store.find(id)) : nullptr;
+}
+
+void casino_sessions_close(casino_sessions* store, uint32_t id) {
+    if (!store) return;
+    try {
+        store->store.close(id);
+    } catch (const std::bad_alloc&) {
+    }
+}
+
+int casino_sessions_checkpoint(casino_sessions* store, const char* path) {
+    if (!store || !path) return -1;
+    try {
+        return store->store.checkpoint(path) ? 0 : -1;
+    } catch (const std::bad_alloc&) {
+        return -1;
+    }
+}
+
+int casino_sessions_restore(casino_sessions* store, const char* path) {
+    if (!store || !path) return -1;
+    try {
+        return store->store.restore(path) ? 0 : -1;
+    } catch (const std::bad_alloc&) {
+        return -1;
+    }
+}
+
+size_t casino_sessions_dropped(const casino_sessions* store, uint32_t* ids_out, size_t capacity) {
+    if (!store) return 0;
+    const std::vector<uint32_t>& dropped = store->store.dropped_on_restore();
+    if (ids_out) std::copy_n(dropped.begin(), std::min(capacity, dropped.size()), ids_out);
+    return dropped.size();
+}
+
+}
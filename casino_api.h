@@ -0,0 +1,107 @@
+#ifndef CASINO_API_H
+#define CASINO_API_H
+
+/*
+ * Stable C ABI over casino_core. Every batch call plays up to n rounds on one
+ * table, settles each against *balance in place and writes per-round results
+ * into caller-provided buffers. Output buffers may be NULL when the caller
+ * does not need them. Batches stop early once *balance drops below bet, or
+ * before a round whose largest possible payout would take *balance past
+ * INT32_MAX; the return value is the number of rounds actually played. Batch
+ * calls never allocate.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CASINO_API_VERSION 3
+
+typedef struct casino_table casino_table;
+typedef struct casino_sessions casino_sessions;
+
+/* Blackjack results written by casino_blackjack_play_batch. */
+enum {
+    CASINO_BJ_PLAYER_BLACKJACK = 0,
+    CASINO_BJ_BLACKJACK_PUSH = 1,
+    CASINO_BJ_PLAYER_BUST = 2,
+    CASINO_BJ_DEALER_BLACKJACK = 3,
+    CASINO_BJ_DEALER_BUST = 4,
+    CASINO_BJ_PLAYER_WIN = 5,
+    CASINO_BJ_DEALER_WIN = 6,
+    CASINO_BJ_PUSH = 7
+};
+
+uint32_t casino_api_version(void);
+
+/* Same seed, same sequence of outcomes. Returns NULL on allocation failure. */
+casino_table* casino_table_create(uint32_t seed);
+void casino_table_destroy(casino_table* table);
+
+/*
+ * The wallet persisted with the table. Batch calls load it from *balance and
+ * bet, settle against it and leave the result here as well as in *balance.
+ */
+void casino_table_get_player(const casino_table* table, int32_t* balance, int32_t* bet);
+void casino_table_set_player(casino_table* table, int32_t balance, int32_t bet);
+
+/*
+ * 1x3 slots. symbols_out receives 3 symbol indices per spin, multipliers_out
+ * one payout multiplier per spin (0 for a loss).
+ */
+size_t casino_slots_spin_batch(casino_table* table, int32_t* balance, int32_t bet, size_t n,
+                               uint8_t* symbols_out, int32_t* multipliers_out);
+
+/*
+ * 3x3 slots. symbols_out receives 9 row-major symbol indices per spin,
+ * multipliers_out the summed line multiplier, lines_out a bitmask of the
+ * paying lines (bit 0 = top row ... bit 4 = anti-diagonal).
+ */
+size_t casino_slots3x3_spin_batch(casino_table* table, int32_t* balance, int32_t bet, size_t n,
+                                  uint8_t* symbols_out, int32_t* multipliers_out, uint8_t* lines_out);
+
+/*
+ * Blackjack with a fresh shuffled deck per round. The player hits while below
+ * stand_on; the dealer stands on 17. results_out receives one CASINO_BJ_* per
+ * round.
+ */
+size_t casino_blackjack_play_batch(casino_table* table, int32_t* balance, int32_t bet, int32_t stand_on,
+                                   size_t n, uint8_t* results_out);
+
+/*
+ * Tables keyed by dense session id that can be checkpointed to and restored
+ * from a snapshot file. Tables returned here are owned by the store and stay
+ * valid until their id is closed or reopened, or the store is restored or
+ * destroyed.
+ */
+casino_sessions* casino_sessions_create(void);
+void casino_sessions_destroy(casino_sessions* store);
+/* Starts (or restarts) session id. Returns NULL on allocation failure. */
+casino_table* casino_sessions_open(casino_sessions* store, uint32_t id, uint32_t seed);
+/* NULL if id is not live. */
+casino_table* casino_sessions_get(casino_sessions* store, uint32_t id);
+/* On allocation failure the session stays open. */
+void casino_sessions_close(casino_sessions* store, uint32_t id);
+/*
+ * Writes sessions changed since the last checkpoint to path and syncs it.
+ * Restore brings back every session as of the last checkpoint that completed,
+ * with identical subsequent outcomes. Both return 0 on success and -1 on
+ * failure; a failed restore leaves the store as it was.
+ */
+int casino_sessions_checkpoint(casino_sessions* store, const char* path);
+int casino_sessions_restore(casino_sessions* store, const char* path);
+/*
+ * Sessions the last restore had to drop because their records were damaged.
+ * Copies up to capacity ids into ids_out (which may be NULL) and returns how
+ * many there are in total.
+ */
+size_t casino_sessions_dropped(const casino_sessions* store, uint32_t* ids_out, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
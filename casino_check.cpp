@@ -0,0 +1,421 @@
+// Self-checks for the core library and snapshot format. Runs every group,
+// prints each failed check and exits non-zero if any failed; see README.md
+// for the build line.
+
+#include "casino_api.h"
+#include "casino_core.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+// The "identical outcomes" guarantee rests on Mt19937 behaving exactly like
+// std::mt19937, including through the standard distributions and shuffle.
+void check_engine_matches_std() {
+    for (std::uint32_t seed : {0u, 1u, 42u, 5489u, 0xdeadbeefu}) {
+        std::mt19937 expected(seed);
+        Mt19937 actual(seed);
+        bool same = true;
+        for (int i = 0; i < 5000; ++i) same = same && expected() == actual();
+
+        std::uniform_int_distribution<int> dist(0, SLOTS3X3_SYMBOL_COUNT - 1);
+        for (int i = 0; i < 5000; ++i) same = same && dist(expected) == dist(actual);
+
+        std::vector<int> a(DECK_SIZE), b(DECK_SIZE);
+        std::iota(a.begin(), a.end(), 0);
+        std::iota(b.begin(), b.end(), 0);
+        std::shuffle(a.begin(), a.end(), expected);
+        std::shuffle(b.begin(), b.end(), actual);
+        check(same && a == b, "Mt19937 matches std::mt19937");
+    }
+}
+
+// Baseline 3x3 rules: wilds stand in for any symbol, three wilds pay the
+// wild multiplier, mixed non-wild symbols pay nothing.
+void check_slots3x3_wild_rules() {
+    const int W = SLOTS3X3_WILD_SYMBOL;
+    Slots3x3Grid grid = {{{W, W, W}, {0, W, 0}, {W, 1, 1}}};
+    check(check_slots3x3_line(grid, 0) == SLOTS3X3_PAYOUTS[W], "three wilds pay the wild multiplier");
+    check(check_slots3x3_line(grid, 1) == SLOTS3X3_PAYOUTS[0], "one wild completes a pair");
+    check(check_slots3x3_line(grid, 2) == SLOTS3X3_PAYOUTS[1], "wild counts at the start of a line");
+    grid = {{{1, W, W}, {2, 2, 2}, {0, 1, W}}};
+    check(check_slots3x3_line(grid, 0) == SLOTS3X3_PAYOUTS[1], "two wilds complete a single symbol");
+    check(check_slots3x3_line(grid, 1) == SLOTS3X3_PAYOUTS[2], "three of a kind pays");
+    check(check_slots3x3_line(grid, 2) == 0, "a wild does not join two different symbols");
+
+    Slots3x3Grid wilds = {{{W, W, W}, {W, W, W}, {W, W, W}}};
+    unsigned lines = 0;
+    check(evaluate_slots3x3(wilds, &lines) == SLOTS3X3_MAX_MULTIPLIER && lines == 0x1f,
+          "a grid of wilds pays every line");
+    check(evaluate_slots({{4, 4, 4}}) == SLOTS_PAYOUTS[4] && evaluate_slots({{4, 4, 5}}) == 0,
+          "1x3 slots pay only three of a kind");
+}
+
+// Plays single rounds and checks each balance change against the result the
+// batch reported. An odd bet exercises the 3:2 rounding.
+void check_blackjack_settlement() {
+    const std::int32_t bet = 5;
+    casino_table* table = casino_table_create(11);
+    bool settled = true;
+    bool seen[CASINO_BJ_PUSH + 1] = {};
+    for (int round = 0; round < 5000; ++round) {
+        std::int32_t balance = 1000;
+        std::uint8_t result = 0xff;
+        if (casino_blackjack_play_batch(table, &balance, bet, 17, 1, &result) != 1 || result > CASINO_BJ_PUSH) {
+            settled = false;
+            break;
+        }
+        seen[result] = true;
+        std::int32_t expected = 1000;
+        switch (result) {
+            case CASINO_BJ_PLAYER_BLACKJACK: expected += 7; break;
+            case CASINO_BJ_DEALER_BUST:
+            case CASINO_BJ_PLAYER_WIN: expected += bet; break;
+            case CASINO_BJ_PLAYER_BUST:
+            case CASINO_BJ_DEALER_BLACKJACK:
+            case CASINO_BJ_DEALER_WIN: expected -= bet; break;
+            default: break;
+        }
+        settled = settled && balance == expected;
+    }
+    check(settled, "blackjack settles each result (3:2 rounded down, pushes return the bet)");
+    check(std::all_of(std::begin(seen), std::end(seen), [](bool s) { return s; }),
+          "blackjack check saw every result");
+    casino_table_destroy(table);
+}
+
+void check_slots_settlement() {
+    const std::int32_t bet = 3;
+    const std::size_t n = 4000;
+    std::vector<std::uint8_t> symbols(9 * n), lines(n);
+    std::vector<std::int32_t> multipliers(n);
+
+    // A balance this large never runs out, so every spin settles.
+    casino_table* table = casino_table_create(5);
+    std::int32_t balance = 1000000;
+    check(casino_slots_spin_batch(table, &balance, bet, n, symbols.data(), multipliers.data()) == n,
+          "1x3 batch plays every spin");
+    std::int64_t expected = 1000000;
+    bool consistent = true, won = false;
+    for (std::size_t i = 0; i < n; ++i) {
+        SlotsReels reels = {{symbols[3 * i], symbols[3 * i + 1], symbols[3 * i + 2]}};
+        consistent = consistent && multipliers[i] == evaluate_slots(reels);
+        won = won || multipliers[i] > 0;
+        expected += multipliers[i] > 0 ? std::int64_t{bet} * (multipliers[i] - 1) : -bet;
+    }
+    check(consistent && won && balance == expected, "1x3 spins pay bet * multiplier including the stake");
+
+    balance = 1000000;
+    check(casino_slots3x3_spin_batch(table, &balance, bet, n, symbols.data(), multipliers.data(), lines.data()) == n,
+          "3x3 batch plays every spin");
+    expected = 1000000;
+    consistent = true;
+    won = false;
+    for (std::size_t i = 0; i < n; ++i) {
+        Slots3x3Grid grid;
+        for (int c = 0; c < 9; ++c) grid[c / 3][c % 3] = symbols[9 * i + c];
+        unsigned paid = 0;
+        consistent = consistent && multipliers[i] == evaluate_slots3x3(grid, &paid) && lines[i] == paid;
+        won = won || multipliers[i] > 0;
+        expected += multipliers[i] > 0 ? std::int64_t{bet} * (multipliers[i] - 1) : -bet;
+    }
+    check(consistent && won && balance == expected, "3x3 spins pay the summed line multipliers");
+    casino_table_destroy(table);
+}
+
+void check_batch_limits() {
+    casino_table* table = casino_table_create(9);
+    std::int32_t balance = 10;
+    check(casino_slots_spin_batch(table, &balance, 20, 10, nullptr, nullptr) == 0 && balance == 10,
+          "batch refuses a bet above the balance");
+    check(casino_blackjack_play_batch(table, &balance, 0, 17, 10, nullptr) == 0 && balance == 10,
+          "batch refuses a non-positive bet");
+
+    // Losing streaks must end the batch once the balance no longer covers the bet.
+    balance = 50;
+    std::size_t played = casino_slots_spin_batch(table, &balance, 10, 100000, nullptr, nullptr);
+    check(played < 100000 && balance < 10 && balance >= 0, "batch stops when the balance drops below the bet");
+
+    balance = 2147483000;
+    check(casino_slots_spin_batch(table, &balance, 100, 10, nullptr, nullptr) == 0 && balance == 2147483000,
+          "1x3 batch stops before the balance could pass INT32_MAX");
+    check(casino_slots3x3_spin_batch(table, &balance, 100, 10, nullptr, nullptr, nullptr) == 0 &&
+              balance == 2147483000,
+          "3x3 batch stops before the balance could pass INT32_MAX");
+    balance = std::numeric_limits<std::int32_t>::max() - 100;
+    check(casino_blackjack_play_batch(table, &balance, 100, 17, 10, nullptr) == 0 &&
+              balance == std::numeric_limits<std::int32_t>::max() - 100,
+          "blackjack batch stops before the balance could pass INT32_MAX");
+    casino_table_destroy(table);
+
+    // NULL output buffers must not change what is played.
+    casino_table* with = casino_table_create(21);
+    casino_table* without = casino_table_create(21);
+    std::uint8_t symbols[9 * 50], lines[50], results[50];
+    std::int32_t multipliers[50];
+    std::int32_t a = 100000, b = 100000;
+    casino_slots_spin_batch(with, &a, 7, 50, symbols, multipliers);
+    casino_slots_spin_batch(without, &b, 7, 50, nullptr, nullptr);
+    casino_slots3x3_spin_batch(with, &a, 7, 50, symbols, multipliers, lines);
+    casino_slots3x3_spin_batch(without, &b, 7, 50, nullptr, nullptr, nullptr);
+    casino_blackjack_play_batch(with, &a, 7, 15, 50, results);
+    casino_blackjack_play_batch(without, &b, 7, 15, 50, nullptr);
+    check(a == b, "NULL output buffers are skipped");
+    casino_table_destroy(with);
+    casino_table_destroy(without);
+}
+
+// Plays one batch of every game on id from its stored wallet and folds the
+// results into a vector.
+std::vector<std::int64_t> play_all(casino_sessions* store, std::uint32_t id) {
+    std::vector<std::int64_t> out;
+    casino_table* table = casino_sessions_get(store, id);
+    if (!table) return out;
+    std::uint8_t symbols[9 * 8] = {}, lines[8] = {}, results[8] = {};
+    std::int32_t multipliers[8];
+    std::int32_t balance = 0, bet = 0;
+    casino_table_get_player(table, &balance, &bet);
+    casino_slots_spin_batch(table, &balance, 3, 8, symbols, multipliers);
+    out.insert(out.end(), symbols, symbols + 3 * 8);
+    casino_slots3x3_spin_batch(table, &balance, 2, 8, symbols, multipliers, lines);
+    out.insert(out.end(), symbols, symbols + 9 * 8);
+    out.insert(out.end(), lines, lines + 8);
+    casino_blackjack_play_batch(table, &balance, 5, 16, 8, results);
+    out.insert(out.end(), results, results + 8);
+    casino_table_get_player(table, &balance, &bet);
+    out.push_back(balance);
+    out.push_back(bet);
+    return out;
+}
+
+std::vector<char> read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+bool restores(const std::string& path) {
+    casino_sessions* store = casino_sessions_create();
+    bool ok = casino_sessions_restore(store, path.c_str()) == 0;
+    casino_sessions_destroy(store);
+    return ok;
+}
+
+void check_snapshot_round_trip(const std::string& dir) {
+    const std::uint32_t count = 64;
+    const std::string path = dir + "/snapshot.bin";
+
+    casino_sessions* live = casino_sessions_create();
+    for (std::uint32_t id = 0; id < count; ++id) {
+        casino_table* table = casino_sessions_open(live, id, id * 7 + 1);
+        casino_table_set_player(table, 500 + static_cast<std::int32_t>(id), 5);
+        play_all(live, id);
+    }
+    casino_sessions_close(live, 3);
+    check(casino_sessions_checkpoint(live, path.c_str()) == 0, "full checkpoint");
+
+    // Only some sessions change before the incremental checkpoint.
+    for (std::uint32_t id = 0; id < count; id += 5) play_all(live, id);
+    casino_sessions_close(live, 10);
+    casino_sessions_open(live, 3, 99);
+    casino_sessions_open(live, count + 5, 1234);
+    check(casino_sessions_checkpoint(live, path.c_str()) == 0, "incremental checkpoint");
+
+    casino_sessions* restored = casino_sessions_create();
+    check(casino_sessions_restore(restored, path.c_str()) == 0, "restore");
+    check(casino_sessions_get(restored, 10) == nullptr, "closed session stays closed");
+    check(casino_sessions_get(restored, count) == nullptr, "gap stays empty");
+    bool wallets = true;
+    for (std::uint32_t id = 0; id <= count + 5; ++id) {
+        casino_table* a = casino_sessions_get(live, id);
+        casino_table* b = casino_sessions_get(restored, id);
+        if (!a || !b) {
+            wallets = wallets && a == b;
+            continue;
+        }
+        std::int32_t balance_a = 0, bet_a = 0, balance_b = 0, bet_b = 0;
+        casino_table_get_player(a, &balance_a, &bet_a);
+        casino_table_get_player(b, &balance_b, &bet_b);
+        wallets = wallets && balance_a == balance_b && bet_a == bet_b;
+    }
+    check(wallets, "restored sessions keep their wallets");
+    bool same = true;
+    for (std::uint32_t id = 0; id <= count + 5; ++id) {
+        same = same && play_all(live, id) == play_all(restored, id);
+    }
+    check(same, "restored sessions reproduce later outcomes");
+    casino_sessions_destroy(restored);
+    casino_sessions_destroy(live);
+}
+
+void check_restore_rejects(const std::string& dir) {
+    const std::string good = dir + "/snapshot.bin";
+    const std::string bad = dir + "/bad.bin";
+    const std::vector<char> bytes = read_file(good);
+    check(bytes.size() > 64, "snapshot to corrupt exists");
+    if (bytes.size() <= 64) return;
+    check(restores(good), "intact snapshot restores");
+
+    struct { std::size_t offset; const char* what; } fields[] = {
+        {0, "restore rejects bad magic"},
+        {4, "restore rejects other version"},
+        {8, "restore rejects other record_size"},
+    };
+    for (const auto& field : fields) {
+        std::vector<char> corrupt = bytes;
+        corrupt[field.offset] ^= 1;
+        write_file(bad, corrupt);
+        check(!restores(bad), field.what);
+    }
+
+    casino_sessions* store = casino_sessions_create();
+    casino_sessions_open(store, 0, 1);
+    casino_sessions_restore(store, bad.c_str());
+    check(casino_sessions_get(store, 0) != nullptr, "failed restore leaves the store as it was");
+    casino_sessions_destroy(store);
+    std::remove(bad.c_str());
+}
+
+}
+
+const std::size_t SNAPSHOT_HEADER_SIZE = 24;
+
+// Offset of the record slot (0 or 1) holding id, from the sizes in the header.
+std::size_t slot_offset(const std::vector<char>& bytes, std::uint32_t id, int slot) {
+    std::uint32_t record_size = 0;
+    std::memcpy(&record_size, bytes.data() + 8, sizeof(record_size));
+    return SNAPSHOT_HEADER_SIZE + (std::size_t{id} * 2 + slot) * record_size;
+}
+
+void open_sessions(casino_sessions* store, std::uint32_t count) {
+    for (std::uint32_t id = 0; id < count; ++id) {
+        casino_table* table = casino_sessions_open(store, id, id * 13 + 5);
+        casino_table_set_player(table, 800 + static_cast<std::int32_t>(id), 5);
+    }
+}
+
+bool same_outcomes(casino_sessions* a, casino_sessions* b, std::uint32_t count) {
+    bool same = true;
+    for (std::uint32_t id = 0; id < count; ++id) same = same && play_all(a, id) == play_all(b, id);
+    return same;
+}
+
+void check_restore_drops_damaged_record(const std::string& dir) {
+    const std::uint32_t count = 20, damaged = 7;
+    const std::string path = dir + "/damaged.bin";
+    casino_sessions* live = casino_sessions_create();
+    open_sessions(live, count);
+    check(casino_sessions_checkpoint(live, path.c_str()) == 0, "checkpoint to damage");
+
+    std::vector<char> bytes = read_file(path);
+    bytes[slot_offset(bytes, damaged, 0) + 100] ^= 1;
+    write_file(path, bytes);
+
+    casino_sessions* restored = casino_sessions_create();
+    check(casino_sessions_restore(restored, path.c_str()) == 0, "restore survives one damaged record");
+    std::uint32_t ids[4] = {};
+    check(casino_sessions_dropped(restored, ids, 4) == 1 && ids[0] == damaged, "damaged session is reported");
+    check(casino_sessions_get(restored, damaged) == nullptr, "damaged session is dropped");
+    casino_sessions_close(live, damaged);
+    check(same_outcomes(live, restored, count), "other sessions still restore");
+    casino_sessions_destroy(restored);
+    casino_sessions_destroy(live);
+    std::remove(path.c_str());
+}
+
+// A crash during an incremental checkpoint leaves new records, possibly torn,
+// in the file while the header still names the previous checkpoint.
+void check_restore_ignores_uncommitted_checkpoint(const std::string& dir) {
+    const std::uint32_t count = 20;
+    const std::string path = dir + "/crash.bin";
+    const std::string first = dir + "/first.bin";
+    casino_sessions* live = casino_sessions_create();
+    open_sessions(live, count);
+    check(casino_sessions_checkpoint(live, path.c_str()) == 0, "first checkpoint");
+    const std::vector<char> committed = read_file(path);
+    write_file(first, committed);
+
+    for (std::uint32_t id = 0; id < count; id += 2) play_all(live, id);
+    casino_sessions_close(live, 5);
+    check(casino_sessions_checkpoint(live, path.c_str()) == 0, "second checkpoint");
+    std::vector<char> crashed = read_file(path);
+    std::copy(committed.begin(), committed.begin() + SNAPSHOT_HEADER_SIZE, crashed.begin());
+    crashed[slot_offset(crashed, 4, 1) + 100] ^= 1;
+    write_file(path, crashed);
+
+    casino_sessions* expected = casino_sessions_create();
+    casino_sessions* restored = casino_sessions_create();
+    check(casino_sessions_restore(expected, first.c_str()) == 0, "first checkpoint restores");
+    check(casino_sessions_restore(restored, path.c_str()) == 0, "crashed checkpoint restores");
+    check(casino_sessions_dropped(restored, nullptr, 0) == 0, "uncommitted records are not reported");
+    check(casino_sessions_get(restored, 5) != nullptr, "uncommitted close is ignored");
+
+    // The next checkpoint must not commit the stale records along with it.
+    check(casino_sessions_checkpoint(restored, path.c_str()) == 0, "checkpoint after restore");
+    casino_sessions* again = casino_sessions_create();
+    check(casino_sessions_restore(again, path.c_str()) == 0, "restore after recovery");
+    bool resumed = true, carried_on = true;
+    for (std::uint32_t id = 0; id < count; ++id) {
+        std::vector<std::int64_t> want = play_all(expected, id);
+        resumed = resumed && play_all(restored, id) == want;
+        carried_on = carried_on && play_all(again, id) == want;
+    }
+    check(resumed, "restore resumes from the last committed checkpoint");
+    check(carried_on, "checkpoint after restore drops uncommitted records");
+
+    casino_sessions_destroy(again);
+    casino_sessions_destroy(restored);
+    casino_sessions_destroy(expected);
+    casino_sessions_destroy(live);
+    std::remove(path.c_str());
+    std::remove(first.c_str());
+}
+
+int main() {
+    char dir_template[] = "/tmp/casino_check.XXXXXX";
+    const char* dir = ::mkdtemp(dir_template);
+    if (!dir) {
+        std::printf("FAIL: cannot create temp dir\n");
+        return 1;
+    }
+
+    check_engine_matches_std();
+    check_slots3x3_wild_rules();
+    check_blackjack_settlement();
+    check_slots_settlement();
+    check_batch_limits();
+    check_snapshot_round_trip(dir);
+    check_restore_rejects(dir);
+    check_restore_drops_damaged_record(dir);
+    check_restore_ignores_uncommitted_checkpoint(dir);
+
+    std::remove((std::string(dir) + "/snapshot.bin").c_str());
+    ::rmdir(dir);
+    if (failures == 0) std::printf("all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
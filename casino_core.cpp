@@ -0,0 +1,163 @@
+#include "casino_core.h"
+
+#include <chrono>
+
+namespace {
+
+std::uint32_t clock_seed() {
+    return static_cast<std::uint32_t>(std::chrono::system_clock::now().time_since_epoch().count());
+}
+
+}
+
+void Mt19937::twist() {
+    const std::uint32_t upper = 0x80000000u, lower = 0x7fffffffu, matrix = 0x9908b0dfu;
+    for (std::size_t i = 0; i < STATE_SIZE; ++i) {
+        std::uint32_t y = (state[i] & upper) | (state[(i + 1) % STATE_SIZE] & lower);
+        state[i] = state[(i + 397) % STATE_SIZE] ^ (y >> 1) ^ ((y & 1u) ? matrix : 0u);
+    }
+    index = 0;
+}
+
+Deck::Deck() : Deck(clock_seed()) {}
+
+Deck::Deck(std::uint32_t seed) : rng(seed) {
+    deck.reserve(DECK_SIZE);
+    reset();
+}
+
+Deck::Deck(Unseeded tag) : rng(tag) {
+    deck.reserve(DECK_SIZE);
+}
+
+void Deck::reset() {
+    deck.clear();
+    for (Suit s : ALL_SUITS) {
+        for (Rank r : ALL_RANKS) {
+            deck.emplace_back(s, r);
+        }
+    }
+}
+
+void deal_blackjack(Deck& deck, Hand& player_hand, Hand& dealer_hand) {
+    deck.reset();
+    deck.shuffle();
+    player_hand.clear();
+    dealer_hand.clear();
+    player_hand.add_card(deck.deal());
+    dealer_hand.add_card(deck.deal());
+    player_hand.add_card(deck.deal());
+    dealer_hand.add_card(deck.deal());
+}
+
+BlackjackResult blackjack_result(const Hand& player_hand, const Hand& dealer_hand) {
+    if (player_hand.is_blackjack()) {
+        return dealer_hand.is_blackjack() ? BlackjackResult::BLACKJACK_PUSH : BlackjackResult::PLAYER_BLACKJACK;
+    }
+    if (player_hand.value > 21) return BlackjackResult::PLAYER_BUST;
+    if (dealer_hand.is_blackjack()) return BlackjackResult::DEALER_BLACKJACK;
+    if (dealer_hand.value > 21) return BlackjackResult::DEALER_BUST;
+    if (dealer_hand.value > player_hand.value) return BlackjackResult::DEALER_WIN;
+    if (dealer_hand.value < player_hand.value) return BlackjackResult::PLAYER_WIN;
+    return BlackjackResult::PUSH;
+}
+
+void settle_blackjack(Player& player, BlackjackResult result) {
+    switch (result) {
+        case BlackjackResult::PLAYER_BLACKJACK: player.apply_blackjack_win(); break;
+        case BlackjackResult::DEALER_BUST:
+        case BlackjackResult::PLAYER_WIN: player.win_bet(); break;
+        case BlackjackResult::PLAYER_BUST:
+        case BlackjackResult::DEALER_BLACKJACK:
+        case BlackjackResult::DEALER_WIN: player.lose_bet(); break;
+        case BlackjackResult::BLACKJACK_PUSH:
+        case BlackjackResult::PUSH: break;
+    }
+}
+
+BlackjackResult play_blackjack_round(Deck& deck, Hand& player_hand, Hand& dealer_hand, int stand_on) {
+    deal_blackjack(deck, player_hand, dealer_hand);
+    if (player_hand.is_blackjack()) return blackjack_result(player_hand, dealer_hand);
+
+    while (player_hand.value < stand_on && player_hand.value < 21) {
+        player_hand.add_card(deck.deal());
+    }
+    if (player_hand.value > 21 || dealer_hand.is_blackjack()) {
+        return blackjack_result(player_hand, dealer_hand);
+    }
+
+    while (dealer_hand.value < DEALER_STANDS_ON) {
+        dealer_hand.add_card(deck.deal());
+    }
+    return blackjack_result(player_hand, dealer_hand);
+}
+
+bool high_low_wins(const Card& first, const Card& second, bool guess_higher) {
+    int v1 = first.getValue();
+    int v2 = second.getValue();
+    return (v2 > v1 && guess_higher) || (v2 < v1 && !guess_higher);
+}
+
+void spin_slots(Mt19937& rng, SlotsReels& reels) {
+    std::uniform_int_distribution<int> dist(0, SLOTS_SYMBOL_COUNT - 1);
+    for (int& symbol : reels) symbol = dist(rng);
+}
+
+int evaluate_slots(const SlotsReels& reels) {
+    if (reels[0] == reels[1] && reels[1] == reels[2]) return SLOTS_PAYOUTS[reels[0]];
+    return 0;
+}
+
+void spin_slots3x3(Mt19937& rng, Slots3x3Grid& grid) {
+    std::uniform_int_distribution<int> dist(0, SLOTS3X3_SYMBOL_COUNT - 1);
+    for (auto& row : grid) {
+        for (int& symbol : row) symbol = dist(rng);
+    }
+}
+
+int check_slots3x3_line(const Slots3x3Grid& grid, int line) {
+    // Wilds stand in for any symbol; three wilds pay the wild multiplier.
+    int symbol = SLOTS3X3_WILD_SYMBOL;
+    for (const auto& cell : SLOTS3X3_WIN_LINES[line]) {
+        int s = grid[cell[0]][cell[1]];
+        if (s == SLOTS3X3_WILD_SYMBOL) continue;
+        if (symbol == SLOTS3X3_WILD_SYMBOL) symbol = s;
+        else if (s != symbol) return 0;
+    }
+    return SLOTS3X3_PAYOUTS[symbol];
+}
+
+int evaluate_slots3x3(const Slots3x3Grid& grid, unsigned* winning_lines) {
+    int total = 0;
+    unsigned lines = 0;
+    for (int i = 0; i < SLOTS3X3_LINE_COUNT; ++i) {
+        int payout = check_slots3x3_line(grid, i);
+        if (payout > 0) {
+            total += payout;
+            lines |= 1u << i;
+        }
+    }
+    if (winning_lines) *winning_lines = lines;
+    return total;
+}
+
+void settle_spin(Player& player, int multiplier) {
+    if (multiplier > 0) player.balance = clamp_balance(player.balance + std::int64_t{player.bet} * (multiplier - 1));
+    else player.lose_bet();
+}
+
+Table::Table() : Table(clock_seed()) {}
+
+Table::Table(std::uint32_t seed) : deck(seed), slots_rng(seed + 1), slots3x3_rng(seed + 2) {
+    reserve_hands();
+}
+
+Table::Table(Unseeded tag) : deck(tag), slots_rng(tag), slots3x3_rng(tag) {
+    reserve_hands();
+}
+
+void Table::reserve_hands() {
+    // Sized up front so playing rounds never allocates.
+    player_hand.cards.reserve(DECK_SIZE);
+    dealer_hand.cards.reserve(DECK_SIZE);
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+// Game logic shared by the interactive client (main.cpp) and the C ABI
+// (casino_api.h). Nothing in here touches iostream; callers own all I/O.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+enum class Suit { HEARTS, DIAMONDS, SPADES, CLUBS };
+enum class Rank { TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN, JACK, QUEEN, KING, ACE };
+
+constexpr std::array<Suit, 4> ALL_SUITS = {Suit::HEARTS, Suit::DIAMONDS, Suit::SPADES, Suit::CLUBS};
+constexpr std::array<Rank, 13> ALL_RANKS = {
+    Rank::TWO, Rank::THREE, Rank::FOUR, Rank::FIVE, Rank::SIX, Rank::SEVEN,
+    Rank::EIGHT, Rank::NINE, Rank::TEN, Rank::JACK, Rank::QUEEN, Rank::KING, Rank::ACE
+};
+
+// Indexed by Rank.
+constexpr std::array<int, 13> CARD_VALUES = {2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 11};
+
+constexpr std::size_t DECK_SIZE = ALL_SUITS.size() * ALL_RANKS.size();
+
+// Tag for building an object whose state is about to be overwritten, as on
+// snapshot restore: skips seeding engines and filling the deck.
+struct Unseeded {};
+
+// Drop-in for std::mt19937 (same output for the same seed) whose state is
+// plain data, so it can be snapshotted and restored byte for byte.
+class Mt19937 {
+public:
+    using result_type = std::uint32_t;
+    static constexpr std::size_t STATE_SIZE = 624;
+
+    std::array<std::uint32_t, STATE_SIZE> state;
+    std::uint32_t index;
+
+    explicit Mt19937(result_type seed = 5489u) { this->seed(seed); }
+    explicit Mt19937(Unseeded) : index(STATE_SIZE) {}
+    void seed(result_type seed) {
+        state[0] = seed;
+        for (std::uint32_t i = 1; i < STATE_SIZE; ++i) {
+            state[i] = 1812433253u * (state[i - 1] ^ (state[i - 1] >> 30)) + i;
+        }
+        index = STATE_SIZE;
+    }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xffffffffu; }
+    result_type operator()() {
+        if (index >= STATE_SIZE) twist();
+        result_type y = state[index++];
+        y ^= y >> 11;
+        y ^= (y << 7) & 0x9d2c5680u;
+        y ^= (y << 15) & 0xefc60000u;
+        y ^= y >> 18;
+        return y;
+    }
+private:
+    void twist();
+};
+
+class Card {
+public:
+    Suit suit;
+    Rank rank;
+    Card(Suit s, Rank r) : suit(s), rank(r) {}
+    int getValue() const { return CARD_VALUES[static_cast<std::size_t>(rank)]; }
+};
+
+class Hand {
+public:
+    std::vector<Card> cards;
+    int value = 0;
+    int aces = 0;
+    void add_card(const Card& card) {
+        cards.push_back(card);
+        value += card.getValue();
+        if (card.rank == Rank::ACE) aces++;
+        adjust_for_ace();
+    }
+    void adjust_for_ace() {
+        while (value > 21 && aces > 0) { value -= 10; aces--; }
+    }
+    void clear() { cards.clear(); value = 0; aces = 0; }
+    bool is_blackjack() const { return value == 21 && cards.size() == 2; }
+};
+
+class Deck {
+private:
+    Mt19937 rng;
+public:
+    std::vector<Card> deck;
+    Deck();
+    explicit Deck(std::uint32_t seed);
+    // Empty deck, engine state left for the caller to fill in.
+    explicit Deck(Unseeded);
+    // Puts all 52 cards back in factory order without reallocating.
+    void reset();
+    void shuffle() { std::shuffle(deck.begin(), deck.end(), rng); }
+    Card deal() {
+        if (deck.empty()) throw std::runtime_error("Dealing empty deck");
+        Card c = deck.back(); deck.pop_back(); return c;
+    }
+    std::size_t size() const { return deck.size(); }
+    Mt19937& engine() { return rng; }
+    const Mt19937& engine() const { return rng; }
+};
+
+// Settlement is done in 64 bits and saturates instead of overflowing int.
+inline int clamp_balance(std::int64_t balance) {
+    return static_cast<int>(std::min<std::int64_t>(std::max<std::int64_t>(balance, std::numeric_limits<int>::min()),
+                                                   std::numeric_limits<int>::max()));
+}
+
+class Player {
+public:
+    int balance;
+    int bet;
+    Player(int initial_balance = 1000) : balance(initial_balance), bet(0) {}
+    void win_bet() { balance = clamp_balance(std::int64_t{balance} + bet); }
+    void apply_blackjack_win() { balance = clamp_balance(std::int64_t{balance} + blackjack_win(bet)); }
+    void lose_bet() { balance = clamp_balance(std::int64_t{balance} - bet); }
+    // 3:2, rounded down.
+    static std::int64_t blackjack_win(int bet) { return std::int64_t{bet} * 3 / 2; }
+    bool place_bet(int amount) {
+        if (amount > 0 && amount <= balance) { bet = amount; return true; }
+        return false;
+    }
+};
+
+// --- Blackjack ---
+
+enum class BlackjackResult {
+    PLAYER_BLACKJACK,
+    BLACKJACK_PUSH,
+    PLAYER_BUST,
+    DEALER_BLACKJACK,
+    DEALER_BUST,
+    PLAYER_WIN,
+    DEALER_WIN,
+    PUSH
+};
+
+const int DEALER_STANDS_ON = 17;
+
+// Resets and shuffles the deck, then deals two cards each, player first.
+void deal_blackjack(Deck& deck, Hand& player_hand, Hand& dealer_hand);
+// Result once both hands are final. Expects the dealer to have drawn already
+// unless the player busted or either side has blackjack.
+BlackjackResult blackjack_result(const Hand& player_hand, const Hand& dealer_hand);
+void settle_blackjack(Player& player, BlackjackResult result);
+// Full round with a fixed player policy: hit while the hand is below stand_on.
+BlackjackResult play_blackjack_round(Deck& deck, Hand& player_hand, Hand& dealer_hand, int stand_on);
+
+// --- High/Low ---
+
+// Equal values lose.
+bool high_low_wins(const Card& first, const Card& second, bool guess_higher);
+
+// --- Slots ---
+
+template <std::size_t N>
+constexpr int max_payout(const std::array<int, N>& payouts) {
+    int best = 0;
+    for (int p : payouts) if (p > best) best = p;
+    return best;
+}
+
+const int SLOTS_REELS = 3;
+const int SLOTS_SYMBOL_COUNT = 6;
+// Multipliers for three of a kind, indexed by symbol.
+constexpr std::array<int, SLOTS_SYMBOL_COUNT> SLOTS_PAYOUTS = {2, 3, 4, 5, 10, 20};
+constexpr int SLOTS_MAX_MULTIPLIER = max_payout(SLOTS_PAYOUTS);
+
+const int SLOTS3X3_SIZE = 3;
+const int SLOTS3X3_SYMBOL_COUNT = 7;
+const int SLOTS3X3_WILD_SYMBOL = 6;
+constexpr std::array<int, SLOTS3X3_SYMBOL_COUNT> SLOTS3X3_PAYOUTS = {2, 3, 5, 7, 10, 15, 25};
+const int SLOTS3X3_LINE_COUNT = 5;
+// Each line is three (row, column) cells.
+constexpr std::array<std::array<std::array<int, 2>, 3>, SLOTS3X3_LINE_COUNT> SLOTS3X3_WIN_LINES = {{
+    {{{0, 0}, {0, 1}, {0, 2}}}, {{{1, 0}, {1, 1}, {1, 2}}}, {{{2, 0}, {2, 1}, {2, 2}}},
+    {{{0, 0}, {1, 1}, {2, 2}}}, {{{0, 2}, {1, 1}, {2, 0}}}
+}};
+// A grid of wilds pays every line.
+constexpr int SLOTS3X3_MAX_MULTIPLIER = max_payout(SLOTS3X3_PAYOUTS) * SLOTS3X3_LINE_COUNT;
+
+using SlotsReels = std::array<int, SLOTS_REELS>;
+using Slots3x3Grid = std::array<std::array<int, SLOTS3X3_SIZE>, SLOTS3X3_SIZE>;
+
+void spin_slots(Mt19937& rng, SlotsReels& reels);
+// Payout multiplier, 0 for no win.
+int evaluate_slots(const SlotsReels& reels);
+
+void spin_slots3x3(Mt19937& rng, Slots3x3Grid& grid);
+int check_slots3x3_line(const Slots3x3Grid& grid, int line);
+// Sum of line multipliers; bit i of *winning_lines is set when line i paid.
+int evaluate_slots3x3(const Slots3x3Grid& grid, unsigned* winning_lines = nullptr);
+
+// A winning spin pays bet * multiplier including the stake; anything else loses the bet.
+void settle_spin(Player& player, int multiplier);
+
+// --- Table ---
+
+// Everything a single seat needs to play any game: the card shoe, the hands
+// in play and the slot machine engines.
+struct Table {
+    Deck deck;
+    Hand player_hand;
+    Hand dealer_hand;
+    Mt19937 slots_rng;
+    Mt19937 slots3x3_rng;
+    Table();
+    explicit Table(std::uint32_t seed);
+    explicit Table(Unseeded);
+private:
+    void reserve_hands();
+};
+
+// A seat plus the wallet playing at it. dirty is set whenever either changes
+// and cleared once the session has been written to a snapshot.
+struct Session {
+    Player player;
+    Table table;
+    bool dirty = true;
+    explicit Session(std::uint32_t seed) : table(seed) {}
+    explicit Session(Unseeded tag) : table(tag) {}
+};
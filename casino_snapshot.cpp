@@ -0,0 +1,345 @@
+#include "casino_snapshot.h"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// generation is the last checkpoint whose records were all synced before
+// the header was written; restore ignores records from later ones.
+struct SnapshotHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint32_t capacity;
+    std::uint64_t generation;
+};
+
+struct EngineRecord {
+    std::uint32_t state[Mt19937::STATE_SIZE];
+    std::uint32_t index;
+};
+
+// Every id owns two record slots. A checkpoint writes into the slot not
+// holding the session's current record, so the previous one survives a
+// crash mid-write.
+const int SLOTS_PER_SESSION = 2;
+
+// Cards are stored as suit * 13 + rank, in deal order for hands and in
+// stack order (next card dealt last) for the deck. The checksum covers every
+// byte after it, so a torn record is never mistaken for a good one. A record
+// with in_use == 0 marks a session closed as of its generation; generation 0
+// is a slot that was never written.
+struct SessionRecord {
+    std::uint64_t checksum;
+    std::uint64_t generation;
+    std::uint32_t in_use;
+    std::int32_t balance;
+    std::int32_t bet;
+    std::uint8_t deck_count;
+    std::uint8_t player_count;
+    std::uint8_t dealer_count;
+    std::uint8_t reserved;
+    std::uint8_t deck[DECK_SIZE];
+    std::uint8_t player_cards[DECK_SIZE];
+    std::uint8_t dealer_cards[DECK_SIZE];
+    EngineRecord deck_engine;
+    EngineRecord slots_engine;
+    EngineRecord slots3x3_engine;
+};
+
+static_assert(std::is_trivially_copyable<SessionRecord>::value, "records are copied as raw bytes");
+
+const std::size_t CHECKSUMMED_OFFSET = offsetof(SessionRecord, generation);
+static_assert((sizeof(SessionRecord) - CHECKSUMMED_OFFSET) % sizeof(std::uint64_t) == 0,
+              "checksum runs over whole words");
+static_assert(sizeof(SnapshotHeader) % alignof(SessionRecord) == 0 && sizeof(SessionRecord) % alignof(SessionRecord) == 0,
+              "records are read in place from the mapping");
+
+const off_t RECORDS_OFFSET = sizeof(SnapshotHeader);
+
+off_t record_offset(std::uint32_t id, int slot) {
+    return RECORDS_OFFSET +
+           (static_cast<off_t>(id) * SLOTS_PER_SESSION + slot) * static_cast<off_t>(sizeof(SessionRecord));
+}
+
+std::uint64_t rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// Four independent lanes so the multiply chain does not serialize the loop.
+std::uint64_t record_checksum(const void* record) {
+    const char* p = static_cast<const char*>(record) + CHECKSUMMED_OFFSET;
+    const std::size_t words = (sizeof(SessionRecord) - CHECKSUMMED_OFFSET) / sizeof(std::uint64_t);
+    const std::uint64_t k = 0x9e3779b97f4a7c15ull;
+    std::uint64_t lanes[4] = {k, k * 2, k * 3, k * 4};
+    for (std::size_t i = 0; i < words; ++i) {
+        std::uint64_t w;
+        std::memcpy(&w, p + i * sizeof(w), sizeof(w));
+        lanes[i & 3] = rotl(lanes[i & 3] ^ w, 29) * k;
+    }
+    std::uint64_t h = lanes[0] ^ rotl(lanes[1], 16) ^ rotl(lanes[2], 32) ^ rotl(lanes[3], 48);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+std::uint8_t encode_card(const Card& card) {
+    return static_cast<std::uint8_t>(static_cast<int>(card.suit) * ALL_RANKS.size() + static_cast<int>(card.rank));
+}
+
+Card decode_card(std::uint8_t code) {
+    return Card(ALL_SUITS[code / ALL_RANKS.size()], ALL_RANKS[code % ALL_RANKS.size()]);
+}
+
+void encode_cards(const std::vector<Card>& cards, std::uint8_t* out, std::uint8_t& count) {
+    count = static_cast<std::uint8_t>(cards.size());
+    for (std::size_t i = 0; i < cards.size(); ++i) out[i] = encode_card(cards[i]);
+}
+
+bool valid_cards(const std::uint8_t* codes, std::uint8_t count) {
+    if (count > DECK_SIZE) return false;
+    for (std::uint8_t i = 0; i < count; ++i) {
+        if (codes[i] >= DECK_SIZE) return false;
+    }
+    return true;
+}
+
+void encode_engine(const Mt19937& engine, EngineRecord& out) {
+    std::memcpy(out.state, engine.state.data(), sizeof(out.state));
+    out.index = engine.index;
+}
+
+void decode_engine(const EngineRecord& in, Mt19937& engine) {
+    std::memcpy(engine.state.data(), in.state, sizeof(in.state));
+    engine.index = in.index;
+}
+
+void encode_closed(std::uint64_t generation, SessionRecord& record) {
+    std::memset(&record, 0, sizeof(record));
+    record.generation = generation;
+    record.checksum = record_checksum(&record);
+}
+
+void encode_session(const Session& session, std::uint64_t generation, SessionRecord& record) {
+    std::memset(&record, 0, sizeof(record));
+    const Table& table = session.table;
+    record.generation = generation;
+    record.in_use = 1;
+    record.balance = session.player.balance;
+    record.bet = session.player.bet;
+    encode_cards(table.deck.deck, record.deck, record.deck_count);
+    encode_cards(table.player_hand.cards, record.player_cards, record.player_count);
+    encode_cards(table.dealer_hand.cards, record.dealer_cards, record.dealer_count);
+    encode_engine(table.deck.engine(), record.deck_engine);
+    encode_engine(table.slots_rng, record.slots_engine);
+    encode_engine(table.slots3x3_rng, record.slots3x3_engine);
+    record.checksum = record_checksum(&record);
+}
+
+// Expects a record whose checksum already matched.
+bool decode_session(const SessionRecord& record, Session& session) {
+    if (!valid_cards(record.deck, record.deck_count) ||
+        !valid_cards(record.player_cards, record.player_count) ||
+        !valid_cards(record.dealer_cards, record.dealer_count)) {
+        return false;
+    }
+    for (const EngineRecord* engine : {&record.deck_engine, &record.slots_engine, &record.slots3x3_engine}) {
+        if (engine->index > Mt19937::STATE_SIZE) return false;
+    }
+
+    Table& table = session.table;
+    session.player.balance = record.balance;
+    session.player.bet = record.bet;
+    table.deck.deck.clear();
+    for (std::uint8_t i = 0; i < record.deck_count; ++i) table.deck.deck.push_back(decode_card(record.deck[i]));
+    // Replaying the cards rebuilds value and ace bookkeeping exactly.
+    table.player_hand.clear();
+    for (std::uint8_t i = 0; i < record.player_count; ++i) table.player_hand.add_card(decode_card(record.player_cards[i]));
+    table.dealer_hand.clear();
+    for (std::uint8_t i = 0; i < record.dealer_count; ++i) table.dealer_hand.add_card(decode_card(record.dealer_cards[i]));
+    decode_engine(record.deck_engine, table.deck.engine());
+    decode_engine(record.slots_engine, table.slots_rng);
+    decode_engine(record.slots3x3_engine, table.slots3x3_rng);
+    session.dirty = false;
+    return true;
+}
+
+bool write_at(int fd, const void* data, std::size_t size, off_t offset) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = ::pwrite(fd, p, size, offset);
+        if (n < 0) return false;
+        p += n;
+        size -= static_cast<std::size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+// Unmaps on every exit from restore, including a throwing allocation.
+struct Mapping {
+    void* addr;
+    std::size_t length;
+    Mapping(void* addr, std::size_t length) : addr(addr), length(length) {}
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+    ~Mapping() { if (addr != MAP_FAILED) ::munmap(addr, length); }
+};
+
+bool sync_parent_dir(const std::string& path) {
+    std::string::size_type slash = path.rfind('/');
+    std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    return (::close(fd) == 0) && ok;
+}
+
+}
+
+Session& SessionStore::open(std::uint32_t id, std::uint32_t seed) {
+    if (id >= sessions.size()) sessions.resize(static_cast<std::size_t>(id) + 1);
+    sessions[id].reset(new Session(seed));
+    return *sessions[id];
+}
+
+Session* SessionStore::find(std::uint32_t id) {
+    return id < sessions.size() ? sessions[id].get() : nullptr;
+}
+
+void SessionStore::close(std::uint32_t id) {
+    if (!find(id)) return;
+    // Recorded first so a failed push_back leaves the session open rather
+    // than gone from memory but still live in the next checkpoint.
+    closed.push_back(id);
+    sessions[id].reset();
+}
+
+bool SessionStore::checkpoint(const std::string& path) {
+    bool full = path != snapshot_path;
+    // A full checkpoint is built beside path and renamed over it once synced,
+    // so the previous snapshot stays intact until the new one is complete.
+    std::string target = full ? path + ".tmp" : path;
+    int fd = ::open(target.c_str(), full ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0644);
+    if (fd < 0) return false;
+    // Until this checkpoint succeeds the file may be half written.
+    snapshot_path.clear();
+
+    const std::uint64_t next = generation + 1;
+    if (full) current_slot.assign(sessions.size(), 1);
+    else current_slot.resize(sessions.size(), 1);
+    SessionRecord record;
+    auto write_record = [&](std::uint32_t id) {
+        int slot = current_slot[id] ^ 1;
+        current_slot[id] = static_cast<std::uint8_t>(slot);
+        return write_at(fd, &record, sizeof(record), record_offset(id, slot));
+    };
+
+    bool ok = true;
+    if (!full) {
+        encode_closed(next, record);
+        for (std::uint32_t id : closed) {
+            if (find(id)) continue; // reopened since, written below
+            ok = ok && write_record(id);
+        }
+    }
+    for (std::uint32_t id = 0; ok && id < sessions.size(); ++id) {
+        Session* session = sessions[id].get();
+        if (!session || !(full || session->dirty)) continue;
+        encode_session(*session, next, record);
+        ok = write_record(id);
+        session->dirty = false;
+    }
+
+    const std::uint32_t capacity = static_cast<std::uint32_t>(sessions.size());
+    ok = ok && ::ftruncate(fd, record_offset(capacity, 0)) == 0;
+    // In place, the records must be durable before the header commits them.
+    if (!full) ok = ok && ::fsync(fd) == 0;
+    SnapshotHeader header = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION, sizeof(SessionRecord), capacity, next};
+    ok = ok && write_at(fd, &header, sizeof(header), 0);
+    ok = ok && ::fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    if (full) {
+        ok = ok && ::rename(target.c_str(), path.c_str()) == 0 && sync_parent_dir(path);
+        if (!ok) ::unlink(target.c_str());
+    }
+    if (!ok) return false;
+
+    closed.clear();
+    generation = next;
+    snapshot_path = path;
+    return true;
+}
+
+bool SessionStore::restore(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < RECORDS_OFFSET) {
+        ::close(fd);
+        return false;
+    }
+    std::size_t length = static_cast<std::size_t>(st.st_size);
+    Mapping mapping(::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0), length);
+    ::close(fd);
+    if (mapping.addr == MAP_FAILED) return false;
+    ::madvise(mapping.addr, length, MADV_SEQUENTIAL);
+    const char* base = static_cast<const char*>(mapping.addr);
+
+    SnapshotHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION ||
+        header.record_size != sizeof(SessionRecord) || record_offset(header.capacity, 0) > st.st_size) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Session>> restored(header.capacity);
+    std::vector<std::uint32_t> lost;
+    for (std::uint32_t id = 0; id < header.capacity; ++id) {
+        // Records start on 8-byte boundaries of a page-aligned mapping.
+        const SessionRecord* slots[SLOTS_PER_SESSION] = {
+            reinterpret_cast<const SessionRecord*>(base + record_offset(id, 0)),
+            reinterpret_cast<const SessionRecord*>(base + record_offset(id, 1)),
+        };
+        // Newest committed slot first; the other is the fallback if it is damaged.
+        int first = slots[1]->generation > slots[0]->generation ? 1 : 0;
+        const SessionRecord* chosen = nullptr;
+        bool damaged = false;
+        for (int slot : {first, first ^ 1}) {
+            const SessionRecord& record = *slots[slot];
+            // Never written, or left by a checkpoint that did not commit.
+            if (record.generation == 0 || record.generation > header.generation) continue;
+            if (record.checksum == record_checksum(&record)) {
+                chosen = &record;
+                break;
+            }
+            damaged = true;
+        }
+        if (!chosen) {
+            if (damaged) lost.push_back(id);
+            continue;
+        }
+        if (!chosen->in_use) continue;
+        restored[id].reset(new Session(Unseeded{}));
+        if (!decode_session(*chosen, *restored[id])) {
+            restored[id].reset();
+            lost.push_back(id);
+        }
+    }
+
+    sessions.swap(restored);
+    dropped.swap(lost);
+    closed.clear();
+    generation = header.generation;
+    // Slots from an uncommitted checkpoint may still sit in the file, so the
+    // next checkpoint rewrites it in full rather than reusing them.
+    current_slot.clear();
+    snapshot_path.clear();
+    return true;
+}
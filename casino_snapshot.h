@@ -0,0 +1,60 @@
+#pragma once
+
+// Live sessions and their on-disk snapshot.
+//
+// A snapshot is a header followed by two fixed-size record slots per session
+// id, so a checkpoint only writes the records of sessions that changed since
+// the previous one. Records carry the deck, both hands, the player's balance
+// and pending bet and the full state of every engine, so a restored session
+// continues with exactly the outcomes it would have produced. The format is
+// native-endian; a snapshot from a host with the other byte order fails the
+// magic check.
+//
+// Full checkpoints replace the file atomically. Incremental ones write each
+// changed session into its older slot, sync, then commit by bumping the
+// generation in the header. Restore takes every session from the last
+// committed checkpoint, so a crash mid-checkpoint loses only that checkpoint.
+// A session whose committed record is damaged anyway is dropped and reported;
+// the others still restore.
+
+#include "casino_core.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+const std::uint32_t SNAPSHOT_MAGIC = 0x504e5343; // "CSNP"
+const std::uint32_t SNAPSHOT_VERSION = 3;
+
+class SessionStore {
+public:
+    // Ids are dense slot numbers; the record for id lives at a fixed offset.
+    // Opening an id that is already live starts it over.
+    Session& open(std::uint32_t id, std::uint32_t seed);
+    Session* find(std::uint32_t id);
+    // Strong guarantee: if recording the close throws, the session stays open.
+    void close(std::uint32_t id);
+
+    // Writes every dirty or closed session to path and syncs it. The first
+    // checkpoint to a path (or the first after a failure) rewrites the whole
+    // file through path + ".tmp". Returns false on I/O error.
+    bool checkpoint(const std::string& path);
+    // Replaces the store's contents with the snapshot at path. Returns false,
+    // leaving the store untouched, if the file is missing or its header does
+    // not match this version. The next checkpoint after a restore is full.
+    bool restore(const std::string& path);
+    // Ids the last restore found in the file but could not read back.
+    const std::vector<std::uint32_t>& dropped_on_restore() const { return dropped; }
+
+private:
+    std::vector<std::unique_ptr<Session>> sessions;
+    std::vector<std::uint32_t> closed;
+    std::vector<std::uint32_t> dropped;
+    // Slot holding each id's newest record in snapshot_path.
+    std::vector<std::uint8_t> current_slot;
+    // Last committed checkpoint.
+    std::uint64_t generation = 0;
+    // File whose records already match every clean session.
+    std::string snapshot_path;
+};
@@ -12,12 +12,10 @@
 #include <utility>
 #include <memory>
 
-using namespace std;
+#include "casino_core.h"
 
-enum class Suit { HEARTS, DIAMONDS, SPADES, CLUBS };
-enum class Rank { TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN, JACK, QUEEN, KING, ACE };
+using namespace std;
 
-const vector<Suit> ALL_SUITS = {Suit::HEARTS, Suit::DIAMONDS, Suit::SPADES, Suit::CLUBS};
 string suitToString(Suit s) {
     switch (s) {
         case Suit::HEARTS: return "♥";
@@ -28,10 +26,6 @@ string suitToString(Suit s) {
     }
 }
 
-const vector<Rank> ALL_RANKS = {
-    Rank::TWO, Rank::THREE, Rank::FOUR, Rank::FIVE, Rank::SIX, Rank::SEVEN,
-    Rank::EIGHT, Rank::NINE, Rank::TEN, Rank::JACK, Rank::QUEEN, Rank::KING, Rank::ACE
-};
 string rankToString(Rank r) {
     switch (r) {
         case Rank::TWO: return "Two";
@@ -51,85 +45,10 @@ string rankToString(Rank r) {
     }
 }
 
-const map<Rank, int> card_values = {
-    {Rank::TWO, 2}, {Rank::THREE, 3}, {Rank::FOUR, 4}, {Rank::FIVE, 5},
-    {Rank::SIX, 6}, {Rank::SEVEN, 7}, {Rank::EIGHT, 8}, {Rank::NINE, 9},
-    {Rank::TEN, 10}, {Rank::JACK, 10}, {Rank::QUEEN, 10}, {Rank::KING, 10},
-    {Rank::ACE, 11}
-};
-
-class Card {
-public:
-    Suit suit;
-    Rank rank;
-    Card(Suit s, Rank r) : suit(s), rank(r) {}
-    friend ostream& operator<<(ostream& os, const Card& card) {
-        os << rankToString(card.rank) << " of " << suitToString(card.suit);
-        return os;
-    }
-    int getValue() const {
-        try {
-            return card_values.at(rank);
-        } catch (const out_of_range&) {
-            return 0;
-        }
-    }
-};
-
-class Hand {
-public:
-    vector<Card> cards;
-    int value = 0;
-    int aces = 0;
-    void add_card(const Card& card) {
-        cards.push_back(card);
-        value += card.getValue();
-        if (card.rank == Rank::ACE) aces++;
-        adjust_for_ace();
-    }
-    void adjust_for_ace() {
-        while (value > 21 && aces > 0) { value -= 10; aces--; }
-    }
-    void clear() { cards.clear(); value = 0; aces = 0; }
-};
-
-class Deck {
-private:
-    mt19937 rng;
-public:
-    vector<Card> deck;
-    Deck() {
-        unsigned seed = chrono::system_clock::now().time_since_epoch().count();
-        rng = mt19937(seed);
-        for (Suit s : ALL_SUITS) {
-            for (Rank r : ALL_RANKS) {
-                deck.emplace_back(s, r);
-            }
-        }
-    }
-    void shuffle() { std::shuffle(deck.begin(), deck.end(), rng); }
-    Card deal() {
-        if (deck.empty()) throw runtime_error("Dealing empty deck");
-        Card c = deck.back(); deck.pop_back(); return c;
-    }
-    size_t size() const { return deck.size(); }
-};
-
-class Player {
-public:
-    int balance;
-    int bet;
-    Player(int initial_balance = 1000) : balance(initial_balance), bet(0) {}
-    void win_bet() { balance += bet; }
-    void apply_blackjack_win() { balance += static_cast<int>(bet * 1.5); }
-    void lose_bet() { balance -= bet; }
-    bool place_bet(int amount) {
-        if (amount > 0 && amount <= balance) { bet = amount; return true; }
-        if (amount > balance) cout << "Bet (" << amount << ") exceeds balance (" << balance << ")." << endl;
-        if (amount <= 0) cout << "Bet must be positive." << endl;
-        return false;
-    }
-};
+ostream& operator<<(ostream& os, const Card& card) {
+    os << rankToString(card.rank) << " of " << suitToString(card.suit);
+    return os;
+}
 
 void clear_screen() {
 #ifdef _WIN32
@@ -155,6 +74,8 @@ bool take_bet_generic(Player& player, const string& game_name) {
 
         if (bet_amount == 0) return false;
         if (player.place_bet(bet_amount)) return true;
+        if (bet_amount > player.balance) cout << "Bet (" << bet_amount << ") exceeds balance (" << player.balance << ")." << endl;
+        if (bet_amount <= 0) cout << "Bet must be positive." << endl;
     }
 }
 
@@ -194,14 +115,10 @@ public:
         }
 
         Deck game_deck;
-        game_deck.shuffle();
         Hand player_hand, dealer_hand;
 
         try {
-            player_hand.add_card(game_deck.deal());
-            dealer_hand.add_card(game_deck.deal());
-            player_hand.add_card(game_deck.deal());
-            dealer_hand.add_card(game_deck.deal());
+            deal_blackjack(game_deck, player_hand, dealer_hand);
         } catch (const runtime_error& e) {
             cout << "Error dealing cards: " << e.what() << endl;
             press_enter_to_continue();
@@ -212,8 +129,8 @@ public:
 
         bool player_turn_active = true;
         bool player_busted = false;
-        bool player_has_blackjack = (player_hand.value == 21 && player_hand.cards.size() == 2);
-        bool dealer_has_blackjack = (dealer_hand.value == 21 && dealer_hand.cards.size() == 2);
+        bool player_has_blackjack = player_hand.is_blackjack();
+        bool dealer_has_blackjack = dealer_hand.is_blackjack();
 
         if (player_has_blackjack) {
             cout << "\nPlayer Blackjack!" << endl;
@@ -222,7 +139,6 @@ public:
                 cout << "Dealer also has Blackjack! It's a push." << endl;
             } else {
                 cout << "Player wins with Blackjack (pays 3:2)!" << endl;
-                player.apply_blackjack_win();
             }
             player_turn_active = false;
         }
@@ -251,7 +167,6 @@ public:
 
             if (player_hand.value > 21) {
                 cout << "Player busts with " << player_hand.value << "!" << endl;
-                player.lose_bet();
                 player_busted = true;
                 player_turn_active = false;
             } else if (player_hand.value == 21) {
@@ -268,9 +183,8 @@ public:
 
             if (dealer_has_blackjack && !player_has_blackjack) {
                  cout << "Dealer has Blackjack! Dealer wins." << endl;
-                 player.lose_bet();
             } else {
-                while (dealer_hand.value < 17) {
+                while (dealer_hand.value < DEALER_STANDS_ON) {
                     cout << "Dealer hits." << endl;
                     this_thread::sleep_for(chrono::seconds(1));
                     try {
@@ -285,21 +199,19 @@ public:
 
                 if (dealer_hand.value > 21) {
                     cout << "Dealer busts with " << dealer_hand.value << "! Player wins." << endl;
-                    player.win_bet();
                 } else {
                     cout << "Dealer stands with " << dealer_hand.value << "." << endl;
                     if (dealer_hand.value > player_hand.value) {
                         cout << "Dealer wins." << endl;
-                        player.lose_bet();
                     } else if (dealer_hand.value < player_hand.value) {
                         cout << "Player wins." << endl;
-                        player.win_bet();
                     } else {
                         cout << "It's a push! Bets are returned." << endl;
                     }
                 }
             }
         }
+        settle_blackjack(player, blackjack_result(player_hand, dealer_hand));
         cout << "\nRound over. Your balance: " << player.balance << endl;
         press_enter_to_continue();
     }
@@ -355,22 +267,17 @@ public:
         }
         Card second_card = game_deck.deal();
         cout << "Next card: " << second_card << " (Value: " << second_card.getValue() << ")" << endl;
-        int v1 = first_card.getValue();
-        int v2 = second_card.getValue();
+        bool correct = high_low_wins(first_card, second_card, guess == 'h');
 
-        if (v1 == v2) {
+        if (first_card.getValue() == second_card.getValue()) {
             cout << "\nIt's a tie! Values are the same. You lose your bet." << endl;
-            player.lose_bet();
+        } else if (correct) {
+            cout << "\nCorrect!" << endl;
         } else {
-            bool correct = (v2 > v1 && guess == 'h') || (v2 < v1 && guess == 'l');
-            if (correct) {
-                cout << "\nCorrect!" << endl;
-                player.win_bet();
-            } else {
-                cout << "\nIncorrect." << endl;
-                player.lose_bet();
-            }
+            cout << "\nIncorrect." << endl;
         }
+        if (correct) player.win_bet();
+        else player.lose_bet();
         cout << "\nRound over. Your balance: " << player.balance << endl;
         press_enter_to_continue();
     }
@@ -378,9 +285,9 @@ public:
 
 class SlotsGame : public Game {
 private:
-    mt19937 rng;
+    Mt19937 rng;
+    // Display names, indexed by symbol; payouts live in SLOTS_PAYOUTS.
     const vector<string> symbols = {"🍒", "🍋", "🍊", "🔔", "BAR", " 7 "};
-    const map<string, int> payouts = {{"🍒", 2}, {"🍋", 3}, {"🍊", 4}, {"🔔", 5}, {"BAR", 10}, {" 7 ", 20}};
 public:
     SlotsGame() : rng(chrono::system_clock::now().time_since_epoch().count()) {}
     void play(Player& player) override {
@@ -409,41 +316,28 @@ public:
                     break;
                 }
 
-                uniform_int_distribution<int> dist(0, symbols.size() - 1);
-                vector<string> result;
+                SlotsReels reels;
                 cout << "\nSpinning..." << endl;
                 this_thread::sleep_for(chrono::milliseconds(700));
+                spin_slots(rng, reels);
                 cout << "[ ";
-                for (int i = 0; i < 3; ++i) {
-                    result.push_back(symbols[dist(rng)]);
-                    cout << result[i] << (i < 2 ? " | " : "");
+                for (int i = 0; i < SLOTS_REELS; ++i) {
+                    cout << symbols[reels[i]] << (i < SLOTS_REELS - 1 ? " | " : "");
                 }
                 cout << " ]" << endl << endl;
 
-                bool win_this_spin = false;
-                if (result[0] == result[1] && result[1] == result[2]) {
-                    string sym = result[0];
-                    int multiplier = 0;
-                    try {
-                        multiplier = payouts.at(sym);
-                        win_this_spin = true;
-                        int winnings = player.bet * multiplier;
-                        int profit = winnings - player.bet;
-                        player.balance += profit;
-
-                        cout << "!!! JACKPOT !!! You matched three " << sym << " symbols!" << endl;
-                        cout << "Payout Multiplier: x" << multiplier << endl;
-                        cout << "You win: " << winnings << " (Profit: " << profit << ")" << endl;
-                    } catch (const out_of_range&) {
-                        cout << "Payout Error. This spin is a loss." << endl;
-                        player.balance -= player.bet;
-                    }
-                }
+                int multiplier = evaluate_slots(reels);
+                if (multiplier > 0) {
+                    int winnings = player.bet * multiplier;
+                    int profit = winnings - player.bet;
 
-                if (!win_this_spin) {
+                    cout << "!!! JACKPOT !!! You matched three " << symbols[reels[0]] << " symbols!" << endl;
+                    cout << "Payout Multiplier: x" << multiplier << endl;
+                    cout << "You win: " << winnings << " (Profit: " << profit << ")" << endl;
+                } else {
                     cout << "Sorry, no win this spin." << endl;
-                    player.balance -= player.bet;
                 }
+                settle_spin(player, multiplier);
                 cout << "Balance after spin: " << player.balance << endl;
 
                 if (player.balance <= 0) {
@@ -468,63 +362,12 @@ public:
     }
 };
 
+// Display names, indexed by symbol; the last one is the wild.
 const vector<string> Slots3x3Game_symbols_3x3_data = {" 🍒  ", " 🍋 ", " 🍊 ", " 🔔  ", " ⛔" ," ♿", "⭐"};
-const string Slots3x3Game_WILD_SYMBOL_DATA = "⭐";
-const map<string, int> Slots3x3Game_payouts_3x3_data = {
-    {" 🍒  ", 2}, {" 🍋 ", 3}, {" 🍊 ", 5}, {" 🔔  ", 7}, {" ⛔", 10}, {" ♿", 15}, {Slots3x3Game_WILD_SYMBOL_DATA, 25}
-};
-const vector<vector<pair<int, int>>> Slots3x3Game_win_lines_3x3_data = {
-    {{0, 0}, {0, 1}, {0, 2}}, {{1, 0}, {1, 1}, {1, 2}}, {{2, 0}, {2, 1}, {2, 2}},
-    {{0, 0}, {1, 1}, {2, 2}}, {{0, 2}, {1, 1}, {2, 0}}
-};
 
 class Slots3x3Game : public Game {
 private:
-    mt19937 rng;
-    static int check_line_static(const vector<vector<string>>& grid,
-                          const vector<pair<int, int>>& line_coords) {
-        string s1 = grid[line_coords[0].first][line_coords[0].second];
-        string s2 = grid[line_coords[1].first][line_coords[1].second];
-        string s3 = grid[line_coords[2].first][line_coords[2].second];
-
-        if (s1 == s2 && s2 == s3 && s1 != Slots3x3Game_WILD_SYMBOL_DATA) {
-            try { return Slots3x3Game_payouts_3x3_data.at(s1); } catch(...) { return 0; }
-        }
-        if (s1 == Slots3x3Game_WILD_SYMBOL_DATA && s2 == Slots3x3Game_WILD_SYMBOL_DATA && s3 == Slots3x3Game_WILD_SYMBOL_DATA) {
-            try { return Slots3x3Game_payouts_3x3_data.at(Slots3x3Game_WILD_SYMBOL_DATA); } catch(...) { return 0; }
-        }
-
-        string effective_symbol = "";
-        int wild_count = 0;
-        vector<string> line_symbols = {s1, s2, s3};
-        vector<string> non_wild_symbols;
-
-        for(const auto& sym : line_symbols) {
-            if (sym == Slots3x3Game_WILD_SYMBOL_DATA) {
-                wild_count++;
-            } else {
-                non_wild_symbols.push_back(sym);
-            }
-        }
-
-        if (wild_count > 0 && wild_count < 3) {
-            if (non_wild_symbols.empty()) return 0;
-            bool all_same_non_wild = true;
-            if (non_wild_symbols.size() > 1) {
-                for (size_t i = 1; i < non_wild_symbols.size(); ++i) {
-                    if (non_wild_symbols[i] != non_wild_symbols[0]) {
-                        all_same_non_wild = false;
-                        break;
-                    }
-                }
-            }
-            if (all_same_non_wild) {
-                effective_symbol = non_wild_symbols[0];
-                try { return Slots3x3Game_payouts_3x3_data.at(effective_symbol); } catch(...) { return 0; }
-            }
-        }
-        return 0;
-    }
+    Mt19937 rng;
 
 public:
     Slots3x3Game() : rng(chrono::system_clock::now().time_since_epoch().count() + 1) {}
@@ -554,10 +397,10 @@ public:
                     break;
                 }
 
-                uniform_int_distribution<int> dist(0, Slots3x3Game_symbols_3x3_data.size() - 1);
-                vector<vector<string>> grid(3, vector<string>(3));
+                Slots3x3Grid grid;
                 cout << "\nSpinning..." << endl;
                 this_thread::sleep_for(chrono::milliseconds(700));
+                spin_slots3x3(rng, grid);
 
                 const int cell_width = 6;
                 string h_separator = "+";
@@ -567,8 +410,7 @@ public:
                 for (int r = 0; r < 3; ++r) {
                     cout << "|";
                     for (int c = 0; c < 3; ++c) {
-                        grid[r][c] = Slots3x3Game_symbols_3x3_data[dist(rng)];
-                        cout << " " << left << setw(cell_width) << grid[r][c] << " |";
+                        cout << " " << left << setw(cell_width) << Slots3x3Game_symbols_3x3_data[grid[r][c]] << " |";
                     }
                     cout << endl;
                     if (r < 2) cout << h_separator << endl;
@@ -576,33 +418,25 @@ public:
                  cout << h_separator << endl;
                  cout << endl;
 
-                int total_payout_multiplier = 0;
-                vector<int> winning_lines_indices;
-
-                for(size_t i = 0; i < Slots3x3Game_win_lines_3x3_data.size(); ++i) {
-                    int line_payout = check_line_static(grid, Slots3x3Game_win_lines_3x3_data[i]);
-                    if (line_payout > 0) {
-                        total_payout_multiplier += line_payout;
-                        winning_lines_indices.push_back(i + 1);
-                    }
-                }
+                unsigned winning_lines = 0;
+                int total_payout_multiplier = evaluate_slots3x3(grid, &winning_lines);
 
                 if (total_payout_multiplier > 0) {
                     int total_winnings = player.bet * total_payout_multiplier;
                     int net_change = total_winnings - player.bet;
-                    player.balance += net_change;
 
                     cout << "!!! WIN !!! on line(s): ";
-                    for(size_t i = 0; i < winning_lines_indices.size(); ++i) {
-                        cout << winning_lines_indices[i] << (i < winning_lines_indices.size() - 1 ? ", " : "");
+                    const char* sep = "";
+                    for (int i = 0; i < SLOTS3X3_LINE_COUNT; ++i) {
+                        if (winning_lines & (1u << i)) { cout << sep << i + 1; sep = ", "; }
                     }
                     cout << endl;
                     cout << "Total Payout Multiplier: x" << total_payout_multiplier << endl;
                     cout << "You win: " << total_winnings << " (Net Gain: " << net_change << ")" << endl;
                 } else {
                     cout << "Sorry, no winning lines this spin." << endl;
-                    player.balance -= player.bet;
                 }
+                settle_spin(player, total_payout_multiplier);
                 cout << "Balance after spin: " << player.balance << endl;
 
                 if (player.balance <= 0) {